@@ -6,7 +6,6 @@
 using namespace std::chrono;
 
 struct msg_t {
-    decltype(high_resolution_clock::now()) timestamp;
     std::string val;
 };
 
@@ -16,34 +15,52 @@ void publish() {
     umt::Publisher<msg_t> pub("msg-0");
     for (int i = 0; i < 1000; i++) {
         msg.val = std::to_string(i);
-        msg.timestamp = high_resolution_clock::now();
         pub.push(msg);
+        // 运行过程中打印所有消息的拓扑信息
+        if (i == 500) std::cout << umt::TopicRegistry::dump_json() << umt::TopicRegistry::dump_dot();
         std::this_thread::sleep_for(1ms);
     }
 }
 
-/// 消息订阅函数，收到消息后会打印当前消息从发布到接收之间的延迟时间
+/// 消息订阅函数，收到消息后会打印当前消息从发布到接收之间的延迟时间，以及被覆盖的消息数量
 void subscribe() {
-    msg_t msg;
     umt::Subscriber<msg_t> sub("msg-0", 1);
+    while (true) {
+        try {
+            auto env = sub.pop_envelope();
+            auto dt = duration_cast<microseconds>(steady_clock::now() - env.stamp).count();
+            std::cout << "dt: " << dt << "us, seq: " << env.seq << ", val: " << env.msg.val
+                      << ", dropped: " << sub.get_drop_count() << std::endl;
+        } catch (const umt::MessageError_Stopped &) {
+            break;
+        }
+    }
+}
+
+/// 带过滤的消息订阅函数，只接收偶数消息，且每10条只接收1条，不需要的消息不会进入队列
+void subscribe_filtered() {
+    msg_t msg;
+    umt::Subscriber<msg_t> sub("msg-0");
+    sub.set_filter([](const msg_t &m) { return std::stoi(m.val) % 2 == 0; });
+    sub.set_decimation(10);
     while (true) {
         try {
             msg = sub.pop();
         } catch (const umt::MessageError_Stopped &) {
             break;
         }
-        auto t = high_resolution_clock::now();
-        auto dt = duration_cast<microseconds>(t - msg.timestamp).count();
-        std::cout << "dt: " << dt << "us, val: " << msg.val << std::endl;
+        std::cout << "filtered val: " << msg.val << std::endl;
     }
 }
 
-/// 启动两个订阅线程，和一个发布线程
+/// 启动三个订阅线程，和一个发布线程
 int main() {
     std::thread sub0(subscribe);
     std::thread sub1(subscribe);
+    std::thread sub2(subscribe_filtered);
     publish();
     sub0.join();
     sub1.join();
+    sub2.join();
     return 0;
 }
@@ -0,0 +1,67 @@
+#include "umt/umt.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iostream>
+
+using namespace std::chrono;
+
+struct payload_t {
+    char data[256];
+};
+
+constexpr size_t msg_num = 1000000;
+
+std::atomic<size_t> received{0};
+std::atomic<size_t> dropped{0};
+
+/// 消息订阅函数，统计收到和被覆盖的消息数量；bind_numa为真时将队列内存迁移到当前线程所在的NUMA节点
+/// 队列已满时只会覆盖最老的消息，因此最后一条消息一定会被收到，收到后即退出，不会丢弃队列中剩余的消息
+void subscribe(bool bind_numa) {
+    umt::Subscriber<payload_t> sub("msg-throughput", 1024);
+    if (bind_numa && !sub.set_numa_node()) {
+        std::cout << "numa not available, use default allocator." << std::endl;
+    }
+    size_t cnt = 0;
+    while (true) {
+        try {
+            auto env = sub.pop_envelope();
+            cnt++;
+            if (env.seq + 1 == msg_num) break;
+        } catch (const umt::MessageError_Stopped &) {
+            break;
+        }
+    }
+    received += cnt;
+    dropped += sub.get_drop_count();
+}
+
+/// 用法: example_message_throughput [订阅线程数] [是否绑定NUMA节点(0/1)]
+/// 发布器以最快速度发布消息，最终打印发布和接收的吞吐量，以及因订阅队列已满而被覆盖的消息数量
+int main(int argc, char *argv[]) {
+    int sub_num = argc > 1 ? std::stoi(argv[1]) : 2;
+    bool bind_numa = argc > 2 && std::stoi(argv[2]) != 0;
+
+    umt::Publisher<payload_t> pub("msg-throughput");
+    std::vector<std::thread> subs;
+    for (int i = 0; i < sub_num; i++) subs.emplace_back(subscribe, bind_numa);
+    std::this_thread::sleep_for(100ms);
+
+    payload_t payload{};
+    auto t0 = steady_clock::now();
+    for (size_t i = 0; i < msg_num; i++) {
+        pub.push(payload);
+    }
+    auto t1 = steady_clock::now();
+    for (auto &sub: subs) sub.join();
+    auto t2 = steady_clock::now();
+    pub.reset();
+
+    double pub_sec = duration_cast<duration<double>>(t1 - t0).count();
+    double sub_sec = duration_cast<duration<double>>(t2 - t0).count();
+    std::cout << "publish: " << msg_num / pub_sec << " msg/s, "
+              << "receive: " << received / sub_sec << " msg/s, "
+              << "dropped: " << dropped << " / " << msg_num * sub_num << std::endl;
+    return 0;
+}
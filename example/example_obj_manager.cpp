@@ -1,42 +1,52 @@
 #include "umt/umt.hpp"
 #include <iostream>
 
-/// 查找一个已经存在的命名共享对象并修改其值
+/// 使用多版本共享对象，使得多线程同时读写时不需要额外加锁
+using SharedString = umt::Versioned<std::string>;
+
+/// 查找一个已经存在的命名共享对象并修改其值，修改会作为新版本发布，不影响正在读取的线程
 void func() {
-    auto str = umt::ObjManager<std::string>::find("str-0");
-    if (str) *str = "666";
+    auto str = umt::ObjManager<SharedString>::find("str-0");
+    if (str) str->write("666");
 }
 
 /// 创建一个已经存在的命名共享对象，创建失败
 void error0() {
-    auto str = umt::ObjManager<std::string>::create("str-0");
+    auto str = umt::ObjManager<SharedString>::create("str-0");
     if (!str) std::cout << "create fail!" << std::endl;
 }
 
 /// 查找一个不存在的命名共享对象，查找失败
 void error1() {
-    auto str = umt::ObjManager<std::string>::find("str-1");
+    auto str = umt::ObjManager<SharedString>::find("str-1");
     if (!str) std::cout << "find fail!" << std::endl;
 }
 
-/// 遍历某个类型下的所有命名共享对象
+/// 遍历某个类型下的所有命名共享对象，遍历时只会访问到仍然存活的对象
 void for_each() {
-    for (const auto &name: umt::ObjManager<std::string>::names()) {
-        auto str = umt::ObjManager<std::string>::find(name);
-        // 由于多线程读写，命名对象不一定存在，需要判断find()函数返回值。
-        if (str) {
-            std::cout << name << ": " << *str << std::endl;
-        }
-    }
+    umt::ObjManager<SharedString>::for_each([](const std::string &name, const auto &str) {
+        std::cout << name << ": " << *str->read() << std::endl;
+    });
+}
+
+/// 高频读取时使用Reader，版本未变化时读取完全无锁；旧快照在析构之前始终保持不变
+void reader() {
+    auto str = umt::ObjManager<SharedString>::find("str-0");
+    SharedString::Reader reader(str);
+    auto old = reader.read();
+    str->update([](std::string &val) { val += "!"; });
+    std::cout << "old snapshot: [" << *old << "] version " << old.version() << std::endl;
+    std::cout << "new snapshot: [" << *reader.read() << "] version " << reader.read().version() << std::endl;
 }
 
 int main() {
-    auto str = umt::ObjManager<std::string>::create("str-0", "Hello,World!");
-    std::cout << "after create: [" << *str << "]" << std::endl;
+    auto str = umt::ObjManager<SharedString>::create("str-0", "Hello,World!");
+    std::cout << "after create: [" << *str->read() << "]" << std::endl;
     func();
-    std::cout << "after func: [" << *str << "]" << std::endl;
+    std::cout << "after func: [" << *str->read() << "]" << std::endl;
     for_each();
     error0();
     error1();
+    reader();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,39 @@
+#include "umt/umt.hpp"
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+using namespace std::chrono;
+
+/// 请求处理函数，计算区间[begin, end)内所有整数的和，耗时约10ms
+long long sum(const std::pair<int, int> &range) {
+    std::this_thread::sleep_for(10ms);
+    long long s = 0;
+    for (int i = range.first; i < range.second; i++) s += i;
+    return s;
+}
+
+/// 启动一个有两个工作线程的服务，并分别使用future和带超时的方式调用它
+int main() {
+    umt::ServiceServer<std::pair<int, int>, long long> server("srv-sum", sum, 2);
+    umt::ServiceClient<std::pair<int, int>, long long> client("srv-sum");
+
+    auto f0 = client.call({0, 100});
+    auto f1 = client.call({100, 200});
+    std::cout << "sum[0, 100): " << f0.get() << ", sum[100, 200): " << f1.get() << std::endl;
+
+    try {
+        client.call_for({0, 10}, 1);
+    } catch (const umt::MessageError_Timeout &) {
+        std::cout << "call timeout!" << std::endl;
+    }
+    std::cout << "sum[0, 10): " << client.call_for({0, 10}, 100) << std::endl;
+
+    server.reset();
+    try {
+        client.call({0, 10});
+    } catch (const umt::MessageError_Stopped &) {
+        std::cout << "no server on this service!" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include "umt/umt.hpp"
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+using namespace std::chrono;
+
+/// 消息订阅函数，收到消息后会打印当前消息从发布到接收之间的延迟时间
+void subscribe() {
+    umt::Subscriber<int> sub("msg-timer", 1);
+    while (true) {
+        try {
+            auto env = sub.pop_envelope();
+            if (env.msg % 100 != 0) continue;
+            auto dt = duration_cast<microseconds>(steady_clock::now() - env.stamp).count();
+            std::cout << "dt: " << dt << "us, val: " << env.msg << std::endl;
+        } catch (const umt::MessageError_Stopped &) {
+            break;
+        }
+    }
+}
+
+/// 使用定时调度器每1ms发布一条消息，每100ms翻转一次sync的值，1s后打印定时器统计信息
+int main() {
+    umt::Publisher<int> pub("msg-timer");
+    umt::Sync<bool> sync("sync-timer");
+    std::thread sub(subscribe);
+
+    umt::TimerScheduler scheduler(2);
+    auto pub_id = scheduler.add_publish(1ms, pub, [i = 0]() mutable { return i++; });
+    auto sync_id = scheduler.add_sync(100ms, sync, [flag = false]() mutable { return flag = !flag; });
+    std::this_thread::sleep_for(1s);
+
+    for (auto id: {pub_id, sync_id}) {
+        auto stats = scheduler.stats(id);
+        scheduler.remove(id);
+        std::cout << "timer " << id << ": fire " << stats.fire_cnt << ", overrun " << stats.overrun_cnt
+                  << ", mean jitter " << duration_cast<microseconds>(stats.mean_jitter()).count() << "us"
+                  << ", max jitter " << duration_cast<microseconds>(stats.max_jitter).count() << "us" << std::endl;
+    }
+    pub.reset();
+    sub.join();
+    return 0;
+}
@@ -0,0 +1,227 @@
+#ifndef _UMT_MEMORY_HPP_
+#define _UMT_MEMORY_HPP_
+
+#include <mutex>
+#include <memory>
+#include <new>
+#include <array>
+#include <vector>
+#include <type_traits>
+
+#ifdef _UMT_WITH_NUMA_
+
+#include <numa.h>
+#include <sched.h>
+
+#endif /* _UMT_WITH_NUMA_ */
+
+/// 缓存行大小，可在编译时通过-DUMT_CACHE_LINE_SIZE=xxx覆盖
+#ifndef UMT_CACHE_LINE_SIZE
+#define UMT_CACHE_LINE_SIZE 64
+#endif
+
+namespace umt {
+
+    /// 缓存行大小，用于将不同线程频繁写入的数据隔离到不同缓存行，避免伪共享
+    inline constexpr size_t cache_line_size = UMT_CACHE_LINE_SIZE;
+
+    /**
+     * @brief 判断当前是否启用了NUMA支持（编译时链接libnuma且运行时系统支持NUMA）
+     */
+    inline bool numa_enabled() {
+#ifdef _UMT_WITH_NUMA_
+        static const bool available = numa_available() >= 0;
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 获取当前线程所在的NUMA节点
+     * @return NUMA节点编号，未启用NUMA支持时返回-1
+     */
+    inline int current_numa_node() {
+#ifdef _UMT_WITH_NUMA_
+        if (!numa_enabled()) return -1;
+        int cpu = sched_getcpu();
+        if (cpu < 0) return -1;
+        // libnuma首次查询时会延迟初始化内部表，该过程不是线程安全的
+        static std::mutex mtx;
+        std::unique_lock lock(mtx);
+        return numa_node_of_cpu(cpu);
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief 绑定到某个NUMA节点的内存池
+     * @details 以大块为单位从NUMA节点申请内存，再切分成小块使用；释放的小块挂到对应大小的空闲链表上复用，
+     *          所有内存在内存池析构时统一归还，避免频繁分配时产生系统调用。
+     *          std::deque只会申请固定大小的数据块和少量不同大小的索引数组，因此只为最先出现的几种大小维护空闲链表，
+     *          其余大小直接向NUMA节点申请和释放。
+     *          内存池不满足线程安全性，只能被一个容器使用，由容器的使用者负责加锁。
+     *          未启用NUMA支持时退化为普通的operator new/delete。
+     */
+    class NumaPool {
+    public:
+        explicit NumaPool(int node) : _node(node) {}
+
+        NumaPool(const NumaPool &) = delete;
+
+        NumaPool &operator=(const NumaPool &) = delete;
+
+        ~NumaPool() {
+            for (void *p: _chunks) raw_free(p, chunk_size);
+        }
+
+        int node() const { return _node; }
+
+        void *allocate(size_t size) {
+            size = round_up(size);
+            FreeList *list = find_list(size, true);
+            if (!list) return raw_alloc(size);
+            if (list->head) {
+                Node *p = list->head;
+                list->head = p->next;
+                return p;
+            }
+            if (_chunk_left < size) {
+                _chunk_ptr = static_cast<char *>(raw_alloc(chunk_size));
+                _chunk_left = chunk_size;
+                _chunks.emplace_back(_chunk_ptr);
+            }
+            void *p = _chunk_ptr;
+            _chunk_ptr += size;
+            _chunk_left -= size;
+            return p;
+        }
+
+        void deallocate(void *p, size_t size) {
+            size = round_up(size);
+            FreeList *list = find_list(size, false);
+            if (!list) return raw_free(p, size);
+            list->head = new(p) Node{list->head};
+        }
+
+    private:
+        struct Node {
+            Node *next;
+        };
+
+        struct FreeList {
+            size_t size;
+            Node *head;
+        };
+
+        static size_t round_up(size_t size) {
+            return (size + cache_line_size - 1) / cache_line_size * cache_line_size;
+        }
+
+        /// 查找某个大小的空闲链表，create为true且还有空位时为新的大小创建一个链表
+        FreeList *find_list(size_t size, bool create) {
+            for (size_t i = 0; i < _list_cnt; i++) {
+                if (_lists[i].size == size) return &_lists[i];
+            }
+            if (!create || _list_cnt == max_lists || size > chunk_size / 4) return nullptr;
+            _lists[_list_cnt] = FreeList{size, nullptr};
+            return &_lists[_list_cnt++];
+        }
+
+        void *raw_alloc(size_t size) const {
+#ifdef _UMT_WITH_NUMA_
+            void *p = numa_alloc_onnode(size, _node);
+            if (!p) throw std::bad_alloc();
+            return p;
+#else
+            return ::operator new(size);
+#endif
+        }
+
+        static void raw_free(void *p, size_t size) {
+#ifdef _UMT_WITH_NUMA_
+            numa_free(p, size);
+#else
+            (void) size;
+            ::operator delete(p);
+#endif
+        }
+
+        /// 每次向NUMA节点申请的内存大小
+        static constexpr size_t chunk_size = 64 * 1024;
+        /// 空闲链表数量上限
+        static constexpr size_t max_lists = 4;
+
+        int _node;
+        char *_chunk_ptr{};
+        size_t _chunk_left{};
+        std::vector<void *> _chunks;
+        std::array<FreeList, max_lists> _lists{};
+        size_t _list_cnt{};
+    };
+
+    /**
+     * @brief 在指定NUMA节点上分配内存的分配器
+     * @details 默认构造（或node<0）时与std::allocator行为一致；
+     *          拷贝构造容器时会为新容器创建独立的内存池。内存池不加锁，不能被多个容器共享，
+     *          因此容器间的拷贝和移动赋值不传播分配器，需要转移内存时请使用swap。
+     * @tparam T 分配的对象类型
+     */
+    template<class T>
+    class NumaAllocator {
+        template<class U>
+        friend class NumaAllocator;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::false_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        NumaAllocator() noexcept = default;
+
+        /**
+         * @brief 构造一个绑定到某个NUMA节点的分配器
+         * @param node NUMA节点编号，小于0则使用普通内存分配
+         */
+        explicit NumaAllocator(int node) : p_pool(node < 0 ? nullptr : std::make_shared<NumaPool>(node)) {}
+
+        /// 分配器的移动必须保持源对象不变，因此只提供拷贝语义
+        NumaAllocator(const NumaAllocator &) noexcept = default;
+
+        NumaAllocator &operator=(const NumaAllocator &) noexcept = default;
+
+        template<class U>
+        NumaAllocator(const NumaAllocator<U> &other) noexcept : p_pool(other.p_pool) {}
+
+        T *allocate(size_t n) {
+            if (!p_pool) return std::allocator<T>().allocate(n);
+            return static_cast<T *>(p_pool->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) {
+            if (!p_pool) return std::allocator<T>().deallocate(p, n);
+            p_pool->deallocate(p, n * sizeof(T));
+        }
+
+        NumaAllocator select_on_container_copy_construction() const {
+            return NumaAllocator(node());
+        }
+
+        /// 当前分配器绑定的NUMA节点，未绑定时返回-1
+        int node() const { return p_pool ? p_pool->node() : -1; }
+
+        template<class U>
+        bool operator==(const NumaAllocator<U> &other) const { return p_pool == other.p_pool; }
+
+        template<class U>
+        bool operator!=(const NumaAllocator<U> &other) const { return p_pool != other.p_pool; }
+
+    private:
+        std::shared_ptr<NumaPool> p_pool;
+    };
+}
+
+#endif /* _UMT_MEMORY_HPP_ */
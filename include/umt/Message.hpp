@@ -6,10 +6,15 @@
 #define _UMT_MESSAGE_HPP_
 
 #include "ObjManager.hpp"
+#include "Memory.hpp"
+#include "Registry.hpp"
 #include <condition_variable>
 #include <chrono>
 #include <queue>
 #include <list>
+#include <functional>
+#include <atomic>
+#include <unordered_map>
 
 namespace umt {
 
@@ -51,9 +56,32 @@ namespace umt {
     template<class T>
     class Subscriber;
 
+    /**
+     * @brief 消息信封
+     * @details 发布时为每条消息附加的元数据，与消息一起直接构造在订阅器队列中，不产生额外拷贝
+     * @tparam T 消息对象类型
+     */
+    template<class T>
+    struct MessageEnvelope {
+        using Clock = std::chrono::steady_clock;
+
+        MessageEnvelope(const T &msg, size_t seq, Clock::time_point stamp) : msg(msg), seq(seq), stamp(stamp) {}
+
+        /// 消息对象
+        T msg;
+        /// 消息序号，同一消息上每次发布加一，序号不连续说明中间有消息被丢弃或过滤
+        size_t seq;
+        /// 消息发布时间
+        Clock::time_point stamp;
+    };
+
     /**
      * @brief 消息管道
-     * @details 记录了绑定到该消息上所有publisher和subscriber
+     * @details 记录了绑定到该消息上所有publisher和subscriber。
+     *          subs_mtx在每次发布时都会被写入，而pubs在每次读取消息时都会被订阅器读取，
+     *          因此将两组成员分别放在独立的缓存行上，避免发布与订阅之间的伪共享。
+     *          由ObjManager创建后会自动在TopicRegistry中注册，析构时注销；发布器、订阅器数量等信息使用原子变量记录，
+     *          查询时不需要获取pubs_mtx和subs_mtx。
      * @tparam T 消息对象类型
      */
     template<class T>
@@ -64,25 +92,116 @@ namespace umt {
 
     public:
         using MsgType = T;
+
+        MessagePipe() = default;
+
+        MessagePipe(const MessagePipe &) = delete;
+
+        MessagePipe &operator=(const MessagePipe &) = delete;
+
+        ~MessagePipe() {
+            TopicRegistry::remove(this);
+        }
+
+        /**
+         * @brief 创建回调，由ObjManager在创建该对象后调用，将其注册到TopicRegistry
+         * @param p_pipe 创建出的共享对象
+         */
+        static void on_created(const std::shared_ptr<MessagePipe> &p_pipe) {
+            TopicRegistry::add(p_pipe.get(), p_pipe, &MessagePipe::info);
+        }
+
     private:
-        std::mutex pubs_mtx;
+        /// 读取运行时信息，只读取原子计数和队列配置，不会获取pubs_mtx、subs_mtx或订阅器的锁
+        static TopicInfo info(const std::shared_ptr<void> &p) {
+            static const std::string type = type_name<T>();
+            auto p_pipe = std::static_pointer_cast<MessagePipe>(p);
+            TopicInfo info;
+            info.type = type;
+            info.name = ObjManager<MessagePipe>::name_of(p_pipe);
+            info.pub_cnt = p_pipe->pub_cnt.load(std::memory_order_relaxed);
+            info.sub_cnt = p_pipe->sub_cnt.load(std::memory_order_relaxed);
+            info.msg_cnt = p_pipe->seq.load(std::memory_order_relaxed);
+            info.drop_cnt = p_pipe->drop_cnt.load(std::memory_order_relaxed);
+            std::unique_lock cfg_lock(p_pipe->cfg_mtx);
+            info.fifo_sizes.reserve(p_pipe->fifo_cfg.size());
+            for (const auto &[sub, size]: p_pipe->fifo_cfg) {
+                info.fifo_sizes.emplace_back(size);
+            }
+            return info;
+        }
+
+        /// 调用时需要持有pubs_mtx
+        void add_pub(Publisher<T> *pub) {
+            pubs.emplace_front(pub);
+            pub_cnt.store(pubs.size(), std::memory_order_relaxed);
+        }
+
+        /// 调用时需要持有pubs_mtx
+        void remove_pub(Publisher<T> *pub) {
+            pubs.remove(pub);
+            pub_cnt.store(pubs.size(), std::memory_order_relaxed);
+        }
+
+        /// 调用时需要持有subs_mtx
+        void add_sub(Subscriber<T> *sub) {
+            subs.emplace_front(sub);
+            sub_cnt.store(subs.size(), std::memory_order_relaxed);
+            set_fifo_cfg(sub, sub->get_fifo_size());
+        }
+
+        /// 调用时需要持有subs_mtx
+        void remove_sub(Subscriber<T> *sub) {
+            subs.remove(sub);
+            sub_cnt.store(subs.size(), std::memory_order_relaxed);
+            std::unique_lock cfg_lock(cfg_mtx);
+            fifo_cfg.erase(sub);
+        }
+
+        void set_fifo_cfg(const Subscriber<T> *sub, size_t size) {
+            std::unique_lock cfg_lock(cfg_mtx);
+            fifo_cfg[sub] = size;
+        }
+
+        /// 发布器列表及其数量，只在发布器绑定和解绑时写入
+        alignas(cache_line_size) std::mutex pubs_mtx;
         std::list<Publisher<T> *> pubs;
-        std::mutex subs_mtx;
+        std::atomic<size_t> pub_cnt{};
+        /// 订阅器的队列配置，仅用于TopicRegistry查询，发布时不会访问
+        std::mutex cfg_mtx;
+        std::unordered_map<const Subscriber<T> *, size_t> fifo_cfg;
+
+        /// 订阅器列表及发布计数，每次发布时都会写入
+        alignas(cache_line_size) std::mutex subs_mtx;
         std::list<Subscriber<T> *> subs;
+        std::atomic<size_t> sub_cnt{};
+        /// 下一条消息的序号，只在持有subs_mtx时写入
+        std::atomic<size_t> seq{};
+        /// 所有订阅器因队列已满而被覆盖的消息数量之和
+        std::atomic<size_t> drop_cnt{};
     };
 
     /**
      * @brief 消息订阅器类型
-     * @details 使用队列存储收到的消息，可以设置队列最大长度，当超出最大队列长度时，新消息会覆盖最老的消息
+     * @details 使用队列存储收到的消息，可以设置队列最大长度，当超出最大队列长度时，新消息会覆盖最老的消息。
+     *          每条消息附带发布序号和发布时间，可以通过pop_envelope()系列函数读取。
+     *          对象按缓存行对齐，读多写少的配置成员与锁保护的队列成员位于不同缓存行。
      * @tparam T 消息对象类型
      */
     template<class T>
-    class Subscriber {
+    class alignas(cache_line_size) Subscriber {
         friend Publisher<T>;
     private:
         using MsgManager = ObjManager<MessagePipe<T>>;
+        using Envelope = MessageEnvelope<T>;
+#ifdef _UMT_WITH_NUMA_
+        using FifoType = std::queue<Envelope, std::deque<Envelope, NumaAllocator<Envelope>>>;
+#else
+        using FifoType = std::queue<Envelope>;
+#endif
     public:
         using MsgType = T;
+        using Clock = typename Envelope::Clock;
 
         Subscriber() = default;
 
@@ -96,17 +215,29 @@ namespace umt {
         }
 
         /// 拷贝构造函数
-        Subscriber(const Subscriber &other) : fifo_size(other.fifo_size), fifo(other.fifo), p_msg(other.p_msg) {
+        Subscriber(const Subscriber &other) : fifo_size(other.fifo_size), p_msg(other.p_msg), filter(other.filter),
+                                              decimation(other.decimation), min_interval(other.min_interval),
+                                              fifo(other.fifo) {
             std::unique_lock subs_lock(p_msg->subs_mtx);
-            p_msg->subs.emplace_front(this);
+            p_msg->add_sub(this);
         }
 
         /// 移动构造函数
-        Subscriber(Subscriber &&other) noexcept: fifo_size(other.fifo_size), fifo(std::move(other.fifo)),
-                                                 p_msg(other.p_msg) {
+        /// 如果other已绑定，先在subs_mtx内将其从消息管道中移除，再转移其过滤参数和队列，避免发布器访问到已被移动的成员；
+        /// 未绑定的订阅器同样会转移过滤参数
+        Subscriber(Subscriber &&other) noexcept: fifo_size(other.fifo_size), p_msg(std::move(other.p_msg)) {
+            std::unique_lock<std::mutex> subs_lock;
+            if (p_msg) {
+                subs_lock = std::unique_lock(p_msg->subs_mtx);
+                p_msg->remove_sub(&other);
+            }
+            filter = std::move(other.filter);
+            decimation = other.decimation;
+            min_interval = other.min_interval;
+            fifo.swap(other.fifo);
+            if (p_msg) p_msg->add_sub(this);
+            if (subs_lock) subs_lock.unlock();
             other.reset();
-            std::unique_lock subs_lock(p_msg->subs_mtx);
-            p_msg->subs.emplace_front(this);
         }
 
         /// 析构函数
@@ -114,11 +245,15 @@ namespace umt {
 
         /// 重置订阅器
         void reset() {
-            if (!fifo.empty()) fifo = std::queue<T>();
-            if (!p_msg) return;
-            std::unique_lock subs_lock(p_msg->subs_mtx);
-            p_msg->subs.remove(this);
-            p_msg.reset();
+            if (p_msg) {
+                {
+                    std::unique_lock subs_lock(p_msg->subs_mtx);
+                    p_msg->remove_sub(this);
+                }
+                p_msg.reset();
+            }
+            // 从消息管道中移除后再原地清空队列，保留队列分配器（如NUMA节点绑定）
+            while (!fifo.empty()) fifo.pop();
         }
 
         /**
@@ -129,7 +264,7 @@ namespace umt {
             reset();
             p_msg = MsgManager::find_or_create(msg_name);
             std::unique_lock subs_lock(p_msg->subs_mtx);
-            p_msg->subs.emplace_front(this);
+            p_msg->add_sub(this);
         }
 
         /**
@@ -138,6 +273,7 @@ namespace umt {
          */
         void set_fifo_size(size_t size) {
             fifo_size = size;
+            if (p_msg) p_msg->set_fifo_cfg(this, size);
         }
 
         /**
@@ -148,19 +284,90 @@ namespace umt {
             return fifo_size;
         }
 
+        /**
+         * @brief 设置消息过滤函数，只有过滤函数返回true的消息才会被放入队列
+         * @details 过滤在发布器中、拷贝消息之前进行，被过滤的消息不会产生拷贝、占用队列，也不会唤醒订阅线程。
+         *          过滤函数在发布线程中调用，需要保证其线程安全性。传入空函数则取消过滤。
+         * @param fn 过滤函数，参数为const T&
+         */
+        void set_filter(std::function<bool(const T &)> fn) {
+            auto lock = lock_filter();
+            filter = std::move(fn);
+        }
+
+        /**
+         * @brief 设置消息抽样间隔，每n条消息只接收1条，n<=1则接收所有消息
+         * @details 只统计通过过滤函数的消息
+         * @param n 抽样间隔
+         */
+        void set_decimation(size_t n) {
+            auto lock = lock_filter();
+            decimation = n;
+            decimation_cnt = 0;
+        }
+
+        /**
+         * @brief 设置相邻两条接收消息的最小时间间隔，用于限制接收频率，ms==0则不限制
+         * @details 间隔不足的消息会被直接丢弃
+         * @param ms 最小时间间隔，单位毫秒
+         */
+        void set_min_interval(size_t ms) {
+            auto lock = lock_filter();
+            min_interval = std::chrono::milliseconds(ms);
+            last_accept = {};
+        }
+
+        /**
+         * @brief 将消息队列的存储空间迁移到某个NUMA节点上
+         * @details 一般在消费者线程中调用，使队列内存位于消费者所在的NUMA节点。
+         *          编译时未链接libnuma或系统不支持NUMA时，该函数不做任何操作。
+         * @param node NUMA节点编号，小于0则使用当前线程所在的节点
+         * @return 是否成功迁移
+         */
+        bool set_numa_node(int node = -1) {
+#ifdef _UMT_WITH_NUMA_
+            if (!numa_enabled()) return false;
+            if (node < 0) node = current_numa_node();
+            if (node < 0) return false;
+            std::unique_lock lock(mtx);
+            FifoType tmp{std::deque<Envelope, NumaAllocator<Envelope>>(NumaAllocator<Envelope>(node))};
+            while (!fifo.empty()) {
+                tmp.push(std::move(fifo.front()));
+                fifo.pop();
+            }
+            fifo.swap(tmp);
+            return true;
+#else
+            (void) node;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief 读取因队列已满而被覆盖的消息数量
+         * @return 被覆盖的消息数量
+         */
+        size_t get_drop_count() const {
+            std::unique_lock lock(mtx);
+            return drop_cnt;
+        }
+
+        /**
+         * @brief 读取因过期而被pop_fresh()丢弃的消息数量
+         * @return 过期丢弃的消息数量
+         */
+        size_t get_stale_count() const {
+            std::unique_lock lock(mtx);
+            return stale_cnt;
+        }
+
         /**
          * @brief 尝试获取一条消息
          * @details 如果当前消息上没有发布器，则会抛出一条异常
          * @return 读取到的消息
          */
         T pop() {
-            if (!p_msg) throw MessageError_Empty();
-            std::unique_lock lock(mtx);
-            cv.wait(lock, [this]() { return p_msg->pubs.empty() || !fifo.empty(); });
-            if (p_msg->pubs.empty()) throw MessageError_Stopped();
-            T tmp = std::move(fifo.front());
-            fifo.pop();
-            return tmp;
+            return pop_envelope().msg;
         }
 
         /**
@@ -170,16 +377,7 @@ namespace umt {
          * @return 读取到的消息
          */
         T pop_for(size_t ms) {
-            if (!p_msg) throw MessageError_Empty();
-            using namespace std::chrono;
-            std::unique_lock lock(mtx);
-            if (!cv.wait_for(lock, milliseconds(ms), [this]() { return p_msg->pubs.empty() || !fifo.empty(); })) {
-                throw MessageError_Timeout();
-            }
-            if (p_msg->pubs.empty()) throw MessageError_Stopped();
-            T tmp = std::move(fifo.front());
-            fifo.pop();
-            return tmp;
+            return pop_envelope_for(ms).msg;
         }
 
         /**
@@ -190,24 +388,181 @@ namespace umt {
          */
         template<class P>
         T pop_until(P pt) {
+            return pop_envelope_until(pt).msg;
+        }
+
+        /**
+         * @brief 尝试获取一条消息及其序号和发布时间
+         * @details 如果当前消息上没有发布器，则会抛出一条异常
+         * @return 读取到的消息信封
+         */
+        Envelope pop_envelope() {
+            return pop_impl([this](auto &lock, auto pred) {
+                cv.wait(lock, pred);
+                return true;
+            });
+        }
+
+        /**
+         * @brief 尝试获取一条消息及其序号和发布时间，有超时时间
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param ms 超时时间，单位毫秒
+         * @return 读取到的消息信封
+         */
+        Envelope pop_envelope_for(size_t ms) {
+            return pop_impl([this, ms](auto &lock, auto pred) {
+                return cv.wait_for(lock, std::chrono::milliseconds(ms), pred);
+            });
+        }
+
+        /**
+         * @brief 尝试获取一条消息及其序号和发布时间，直到某个时间点超时
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param pt 超时时间点，为std::chrono::time_point类型
+         * @return 读取到的消息信封
+         */
+        template<class P>
+        Envelope pop_envelope_until(P pt) {
+            return pop_impl([this, pt](auto &lock, auto pred) {
+                return cv.wait_until(lock, pt, pred);
+            });
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息
+         * @details 在持有队列锁时丢弃发布时间早于max_age之前的消息，直到读取到一条未过期的消息。
+         *          如果当前消息上没有发布器，则会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @return 读取到的消息
+         */
+        T pop_fresh(size_t max_age) {
+            return pop_fresh_envelope(max_age).msg;
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息，有超时时间
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @param ms 超时时间，单位毫秒
+         * @return 读取到的消息
+         */
+        T pop_fresh_for(size_t max_age, size_t ms) {
+            return pop_fresh_envelope_for(max_age, ms).msg;
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息，直到某个时间点超时
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @param pt 超时时间点，为std::chrono::time_point类型
+         * @return 读取到的消息
+         */
+        template<class P>
+        T pop_fresh_until(size_t max_age, P pt) {
+            return pop_fresh_envelope_until(max_age, pt).msg;
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息及其序号和发布时间
+         * @details 如果当前消息上没有发布器，则会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @return 读取到的消息信封
+         */
+        Envelope pop_fresh_envelope(size_t max_age) {
+            return pop_fresh_impl(max_age, [this](auto &lock, auto pred) {
+                cv.wait(lock, pred);
+                return true;
+            });
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息及其序号和发布时间，有超时时间
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @param ms 超时时间，单位毫秒
+         * @return 读取到的消息信封
+         */
+        Envelope pop_fresh_envelope_for(size_t max_age, size_t ms) {
+            return pop_fresh_envelope_until(max_age, Clock::now() + std::chrono::milliseconds(ms));
+        }
+
+        /**
+         * @brief 尝试获取一条未过期的消息及其序号和发布时间，直到某个时间点超时
+         * @details 如果当前消息上没有发布器，则会抛出一条异常；如果超时，也会抛出一条异常
+         * @param max_age 消息最大存在时间，单位毫秒
+         * @param pt 超时时间点，为std::chrono::time_point类型
+         * @return 读取到的消息信封
+         */
+        template<class P>
+        Envelope pop_fresh_envelope_until(size_t max_age, P pt) {
+            return pop_fresh_impl(max_age, [this, pt](auto &lock, auto pred) {
+                return cv.wait_until(lock, pt, pred);
+            });
+        }
+
+    private:
+        template<class W>
+        Envelope pop_impl(W &&wait) {
             if (!p_msg) throw MessageError_Empty();
             std::unique_lock lock(mtx);
-            if (!cv.wait_until(lock, pt, [this]() { return p_msg->pubs.empty() || !fifo.empty(); })) {
+            if (!wait(lock, [this]() { return p_msg->pubs.empty() || !fifo.empty(); })) {
                 throw MessageError_Timeout();
             }
             if (p_msg->pubs.empty()) throw MessageError_Stopped();
-            T tmp = std::move(fifo.front());
+            Envelope tmp = std::move(fifo.front());
             fifo.pop();
             return tmp;
         }
 
-    private:
-        void write_obj(const T &obj) {
+        /// 丢弃过期消息后队列为空时会继续等待，因此超时等待需要使用绝对时间点
+        template<class W>
+        Envelope pop_fresh_impl(size_t max_age, W &&wait) {
+            if (!p_msg) throw MessageError_Empty();
             std::unique_lock lock(mtx);
-            if (fifo_size > 0 && fifo.size() >= fifo_size) {
+            while (true) {
+                if (!wait(lock, [this]() { return p_msg->pubs.empty() || !fifo.empty(); })) {
+                    throw MessageError_Timeout();
+                }
+                if (p_msg->pubs.empty()) throw MessageError_Stopped();
+                auto deadline = Clock::now() - std::chrono::milliseconds(max_age);
+                while (!fifo.empty() && fifo.front().stamp < deadline) {
+                    fifo.pop();
+                    stale_cnt++;
+                }
+                if (fifo.empty()) continue;
+                Envelope tmp = std::move(fifo.front());
                 fifo.pop();
+                return tmp;
+            }
+        }
+
+        /// 过滤参数在发布时由发布器读取，修改时需要持有消息管道的subs_mtx
+        std::unique_lock<std::mutex> lock_filter() {
+            if (!p_msg) return {};
+            return std::unique_lock(p_msg->subs_mtx);
+        }
+
+        /// 判断该订阅器是否接收某条消息，由发布器在持有subs_mtx时调用
+        bool accept(const T &obj, typename Clock::time_point now) {
+            if (filter && !filter(obj)) return false;
+            if (decimation > 1 && decimation_cnt++ % decimation != 0) return false;
+            if (min_interval.count() > 0) {
+                if (now - last_accept < min_interval) return false;
+                last_accept = now;
             }
-            fifo.push(obj);
+            return true;
+        }
+
+        /// 写入一条消息，队列已满时覆盖最旧的消息并返回true
+        bool write_obj(const T &obj, size_t seq, typename Clock::time_point stamp) {
+            std::unique_lock lock(mtx);
+            bool dropped = fifo_size > 0 && fifo.size() >= fifo_size;
+            if (dropped) {
+                fifo.pop();
+                drop_cnt++;
+            }
+            fifo.emplace(obj, seq, stamp);
+            return dropped;
         }
 
         void notify() const {
@@ -215,11 +570,23 @@ namespace umt {
         }
 
     private:
-        mutable std::mutex mtx;
-        mutable std::condition_variable cv;
+        /// 读多写少的成员
         size_t fifo_size{};
-        std::queue<T> fifo;
         typename MsgManager::sptr p_msg;
+
+        /// 发布时在拷贝消息之前判断的过滤参数及状态，只由发布器写入
+        alignas(cache_line_size) std::function<bool(const T &)> filter;
+        size_t decimation{};
+        size_t decimation_cnt{};
+        std::chrono::steady_clock::duration min_interval{};
+        std::chrono::steady_clock::time_point last_accept{};
+
+        /// 发布器与订阅器频繁写入的成员，独占缓存行
+        alignas(cache_line_size) mutable std::mutex mtx;
+        mutable std::condition_variable cv;
+        FifoType fifo;
+        size_t drop_cnt{};
+        size_t stale_cnt{};
     };
 
     template<class T>
@@ -242,14 +609,14 @@ namespace umt {
         /// 拷贝构造函数
         Publisher(const Publisher &other) : p_msg(other.p_msg) {
             std::unique_lock pubs_lock(p_msg->pubs_mtx);
-            p_msg->pubs.emplace_front(this);
+            p_msg->add_pub(this);
         }
 
         /// 移动构造函数
         Publisher(Publisher &&other) noexcept: p_msg(other.p_msg) {
             other.reset();
             std::unique_lock pubs_lock(p_msg->pubs_mtx);
-            p_msg->pubs.emplace_front(this);
+            p_msg->add_pub(this);
         }
 
         /// 析构函数
@@ -258,12 +625,14 @@ namespace umt {
         /// 重置发布器
         void reset() {
             if (!p_msg) return;
-            std::unique_lock pubs_lock(p_msg->pubs_mtx);
-            p_msg->pubs.remove(this);
-            if (p_msg->pubs.empty()) {
-                std::unique_lock subs_lock(p_msg->subs_mtx);
-                for (const auto &sub: p_msg->subs) {
-                    sub->notify();
+            {
+                std::unique_lock pubs_lock(p_msg->pubs_mtx);
+                p_msg->remove_pub(this);
+                if (p_msg->pubs.empty()) {
+                    std::unique_lock subs_lock(p_msg->subs_mtx);
+                    for (const auto &sub: p_msg->subs) {
+                        sub->notify();
+                    }
                 }
             }
             p_msg.reset();
@@ -277,7 +646,7 @@ namespace umt {
             reset();
             p_msg = MsgManager::find_or_create(msg_name);
             std::unique_lock pubs_lock(p_msg->pubs_mtx);
-            p_msg->pubs.emplace_front(this);
+            p_msg->add_pub(this);
         }
 
         /**
@@ -287,8 +656,12 @@ namespace umt {
         void push(const T &obj) {
             if (!p_msg) throw MessageError_Empty();
             std::unique_lock subs_lock(p_msg->subs_mtx);
+            size_t seq = p_msg->seq.fetch_add(1, std::memory_order_relaxed);
+            if (p_msg->subs.empty()) return;
+            auto stamp = MessageEnvelope<T>::Clock::now();
             for (auto &sub: p_msg->subs) {
-                sub->write_obj(obj);
+                if (!sub->accept(obj, stamp)) continue;
+                if (sub->write_obj(obj, seq, stamp)) p_msg->drop_cnt.fetch_add(1, std::memory_order_relaxed);
                 sub->notify();
             }
         }
@@ -303,27 +676,33 @@ namespace umt {
 #include <boost/python.hpp>
 
 /// 导出某个类型的发布器类和订阅器类到python。
-#define UMT_EXPORT_PYTHON_MASSAGE_ALIAS(type, name) do{ \
-    using namespace umt;                                \
-    using namespace boost::python;                      \
-    using sub = Subscriber<type>;                       \
-    using pub = Publisher<type>;                        \
-    using msg_##name = MessagePipe<type>;               \
-    class_<sub>("Subscriber_"#name, init<>())           \
-        .def(init<std::string>())                       \
-        .def(init<std::string, size_t>())               \
-        .def("reset", &sub::reset)                      \
-        .def("bind", &sub::bind)                        \
-        .def("set_fifo_size", &sub::set_fifo_size)      \
-        .def("get_fifo_size", &sub::get_fifo_size)      \
-        .def("pop", &sub::pop)                          \
-        .def("pop_for", &sub::pop_for);                 \
-    class_<pub>("Publisher_"#name, init<>())            \
-        .def(init<std::string>())                       \
-        .def("reset", &pub::reset)                      \
-        .def("bind", &pub::bind)                        \
-        .def("push", &pub::push);                       \
-    UMT_EXPORT_PYTHON_OBJ_MANAGER(msg_##name);          \
+#define UMT_EXPORT_PYTHON_MASSAGE_ALIAS(type, name) do{  \
+    using namespace umt;                                 \
+    using namespace boost::python;                       \
+    using sub = Subscriber<type>;                        \
+    using pub = Publisher<type>;                         \
+    using msg_##name = MessagePipe<type>;                \
+    class_<sub>("Subscriber_"#name, init<>())            \
+        .def(init<std::string>())                        \
+        .def(init<std::string, size_t>())                \
+        .def("reset", &sub::reset)                       \
+        .def("bind", &sub::bind)                         \
+        .def("set_fifo_size", &sub::set_fifo_size)       \
+        .def("get_fifo_size", &sub::get_fifo_size)       \
+        .def("set_decimation", &sub::set_decimation)     \
+        .def("set_min_interval", &sub::set_min_interval) \
+        .def("pop", &sub::pop)                           \
+        .def("pop_for", &sub::pop_for)                   \
+        .def("pop_fresh", &sub::pop_fresh)               \
+        .def("pop_fresh_for", &sub::pop_fresh_for)       \
+        .def("get_drop_count", &sub::get_drop_count)     \
+        .def("get_stale_count", &sub::get_stale_count);  \
+    class_<pub>("Publisher_"#name, init<>())             \
+        .def(init<std::string>())                        \
+        .def("reset", &pub::reset)                       \
+        .def("bind", &pub::bind)                         \
+        .def("push", &pub::push);                        \
+    UMT_EXPORT_PYTHON_OBJ_MANAGER(msg_##name);           \
 }while(0)
 
 #define UMT_EXPORT_PYTHON_MASSAGE(type) UMT_EXPORT_PYTHON_MASSAGE_ALIAS(type, type)
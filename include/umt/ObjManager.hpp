@@ -8,6 +8,7 @@
 #include <mutex>
 #include <memory>
 #include <vector>
+#include <type_traits>
 #include <unordered_map>
 
 
@@ -23,11 +24,24 @@ namespace umt {
         explicit ExportPublicConstructor(Ts &&...args): T(std::forward<Ts>(args)...) {}
     };
 
+    /**
+     * @brief 判断被管理对象类型是否提供了创建回调static void on_created(const std::shared_ptr<T> &)
+     */
+    template<class T, class = void>
+    struct has_on_created : std::false_type {
+    };
+
+    template<class T>
+    struct has_on_created<T, std::void_t<decltype(T::on_created(std::declval<const std::shared_ptr<T> &>()))>>
+            : std::true_type {
+    };
+
     /**
      * @brief 命名共享对象管理器
      * @details 通过对象类型和对象名称唯一确定一个共享对象（即std::shared_ptr）
      *          此对象管理器不可用于非class的基本类型（即无法用于int，double等类型）
      *          当导出对象管理器至python时，要求被管理对象类型必须有默认构造函数
+     *          如果被管理对象类型提供了static void on_created(const std::shared_ptr<T> &)，则会在对象创建后以全局锁调用
      *          该对象下的所有函数满足线程安全性
      * @tparam T 被管理的对象类型
      */
@@ -47,9 +61,12 @@ namespace umt {
         template<class ...Ts>
         static sptr create(const std::string &name, Ts &&...args) {
             std::unique_lock lock(_mtx);
-            if (_map.find(name) != _map.end()) return nullptr;
+            auto iter = _map.find(name);
+            if (iter != _map.end() && !iter->second.expired()) return nullptr;
             sptr p_obj = std::make_shared<ExportPublicConstructor<ObjManager<T>>>(name, std::forward<Ts>(args)...);
-            _map.emplace(name, p_obj);
+            _map.insert_or_assign(name, p_obj);
+            _entries.reset();
+            if constexpr (has_on_created<T>::value) T::on_created(p_obj);
             return p_obj;
         }
 
@@ -76,12 +93,22 @@ namespace umt {
         static sptr find_or_create(const std::string &name, Ts &&...args) {
             std::unique_lock lock(_mtx);
             auto iter = _map.find(name);
-            if (iter != _map.end()) return iter->second.lock();
+            if (iter != _map.end()) {
+                // 对象可能正在其他线程中析构，此时其弱引用已失效，但尚未从map中删除
+                if (sptr p_obj = iter->second.lock()) return p_obj;
+            }
             sptr p_obj = std::make_shared<ExportPublicConstructor<ObjManager<T>>>(name, std::forward<Ts>(args)...);
-            _map.emplace(name, p_obj);
+            _map.insert_or_assign(name, p_obj);
+            _entries.reset();
+            if constexpr (has_on_created<T>::value) T::on_created(p_obj);
             return p_obj;
         }
 
+        /**
+         * @brief 获取当前所有命名共享对象的名称
+         * @details 会拷贝所有名称字符串，如果需要遍历对象本身，请使用for_each()或snapshot()
+         * @return 所有对象名称
+         */
         static std::vector<std::string> names() {
             std::unique_lock lock(_mtx);
             std::vector<std::string> _names;
@@ -91,12 +118,54 @@ namespace umt {
             return _names;
         }
 
+        /**
+         * @brief 获取当前所有存活的命名共享对象
+         * @details 只在复制对象列表指针时持有全局锁，之后的遍历不会阻塞对象的创建和删除。
+         *          对象列表在对象创建或删除后的第一次遍历时重建，没有变化时直接复用。
+         * @return 所有存活的共享对象
+         */
+        static std::vector<sptr> snapshot() {
+            auto entries = get_entries();
+            std::vector<sptr> objs;
+            objs.reserve(entries->size());
+            for (const auto &w: *entries) {
+                if (auto p_obj = w.lock()) objs.emplace_back(std::move(p_obj));
+            }
+            return objs;
+        }
+
+        /**
+         * @brief 遍历所有存活的命名共享对象
+         * @details 与snapshot()相同，遍历过程中不持有全局锁，也不会拷贝对象名称
+         * @tparam F 遍历函数类型
+         * @param fn 遍历函数，参数为(const std::string &name, const sptr &obj)
+         */
+        template<class F>
+        static void for_each(F &&fn) {
+            auto entries = get_entries();
+            for (const auto &w: *entries) {
+                if (auto p_obj = w.lock()) fn(name_of(p_obj), p_obj);
+            }
+        }
+
+        /**
+         * @brief 获取某个共享对象的名称
+         * @param p_obj 由该对象管理器创建的共享对象
+         * @return 对象的名称
+         */
+        static const std::string &name_of(const sptr &p_obj) {
+            return static_cast<const ObjManager<T> &>(*p_obj)._name;
+        }
+
         /**
          * @brief 析构函数中，将该对象从map中删除
+         * @details 如果析构期间已经有同名的新对象被创建，则保留新对象
          */
         ~ObjManager() {
             std::unique_lock lock(_mtx);
-            _map.erase(_name);
+            auto iter = _map.find(_name);
+            if (iter != _map.end() && iter->second.expired()) _map.erase(iter);
+            _entries.reset();
         }
 
     protected:
@@ -110,6 +179,20 @@ namespace umt {
         explicit ObjManager(std::string name, Ts &&...args): _name(std::move(name)), T(std::forward<Ts>(args)...) {}
 
     private:
+        /// 获取对象列表，如果对象列表已失效则重新构建
+        static std::shared_ptr<const std::vector<wptr>> get_entries() {
+            std::unique_lock lock(_mtx);
+            if (!_entries) {
+                auto entries = std::make_shared<std::vector<wptr>>();
+                entries->reserve(_map.size());
+                for (const auto &[n, w]: _map) {
+                    entries->emplace_back(w);
+                }
+                _entries = std::move(entries);
+            }
+            return _entries;
+        }
+
         /// 当前对象名称
         std::string _name;
 
@@ -117,6 +200,8 @@ namespace umt {
         static std::mutex _mtx;
         /// 对象map，用于查找命名对象
         static std::unordered_map<std::string, wptr> _map;
+        /// 对象列表缓存，对象创建或删除时失效，用于遍历所有对象
+        static std::shared_ptr<const std::vector<wptr>> _entries;
     };
 
     template<class T>
@@ -124,6 +209,9 @@ namespace umt {
 
     template<class T>
     inline std::unordered_map<std::string, typename ObjManager<T>::wptr> ObjManager<T>::_map;
+
+    template<class T>
+    inline std::shared_ptr<const std::vector<typename ObjManager<T>::wptr>> ObjManager<T>::_entries;
 }
 
 #ifdef _UMT_WITH_BOOST_PYTHON_
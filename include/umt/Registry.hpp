@@ -0,0 +1,219 @@
+#ifndef _UMT_REGISTRY_HPP_
+#define _UMT_REGISTRY_HPP_
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <typeinfo>
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef __GNUG__
+
+#include <cxxabi.h>
+#include <cstdlib>
+
+#endif /* __GNUG__ */
+
+namespace umt {
+
+    template<class T>
+    class MessagePipe;
+
+    /**
+     * @brief 获取某个类型的可读名称
+     * @tparam T 类型
+     * @return 类型名称，GCC/Clang下为demangle后的名称
+     */
+    template<class T>
+    std::string type_name() {
+        const char *name = typeid(T).name();
+#ifdef __GNUG__
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            std::string result(demangled);
+            std::free(demangled);
+            return result;
+        }
+#endif
+        return name;
+    }
+
+    /**
+     * @brief 某个消息的运行时信息
+     */
+    struct TopicInfo {
+        /// 消息对象类型名称
+        std::string type;
+        /// 消息名称
+        std::string name;
+        /// 发布器数量
+        size_t pub_cnt{};
+        /// 订阅器数量
+        size_t sub_cnt{};
+        /// 已发布的消息数量
+        size_t msg_cnt{};
+        /// 所有订阅器因队列已满而被覆盖的消息数量之和
+        size_t drop_cnt{};
+        /// 每个订阅器的最大队列长度，0表示不限制
+        std::vector<size_t> fifo_sizes;
+    };
+
+    /**
+     * @brief 全局消息注册表
+     * @details 所有类型的MessagePipe在创建和析构时自动注册和注销，可用于在运行时查看所有消息及其发布器、订阅器数量，
+     *          以及发现有发布器但没有订阅器等配置不当的消息。查询时只在拷贝注册项时持有全局锁，
+     *          读取各个消息的信息时不持有全局锁，不会阻塞消息的创建和析构。该对象下的所有函数满足线程安全性。
+     */
+    class TopicRegistry {
+        template<class T>
+        friend class MessagePipe;
+
+    public:
+        /**
+         * @brief 获取当前所有消息的运行时信息
+         * @return 按类型和名称排序的消息信息
+         */
+        static std::vector<TopicInfo> topics() {
+            std::vector<Entry> entries;
+            {
+                std::unique_lock lock(_mtx);
+                entries.reserve(_topics.size());
+                for (const auto &[p, entry]: _topics) {
+                    entries.emplace_back(entry);
+                }
+            }
+            std::vector<TopicInfo> infos;
+            infos.reserve(entries.size());
+            for (const auto &[w_pipe, getter]: entries) {
+                if (auto p_pipe = w_pipe.lock()) infos.emplace_back(getter(p_pipe));
+            }
+            std::sort(infos.begin(), infos.end(), [](const TopicInfo &a, const TopicInfo &b) {
+                return a.type != b.type ? a.type < b.type : a.name < b.name;
+            });
+            return infos;
+        }
+
+        /**
+         * @brief 以graphviz DOT格式导出当前所有消息的拓扑结构
+         * @details 没有订阅器的消息标记为红色，没有发布器的消息标记为灰色
+         * @return DOT格式字符串
+         */
+        static std::string dump_dot() {
+            std::ostringstream ss;
+            ss << "digraph umt {\n    rankdir=LR;\n";
+            size_t i = 0;
+            for (const auto &info: topics()) {
+                const char *color = info.sub_cnt == 0 ? "red" : info.pub_cnt == 0 ? "gray" : "black";
+                ss << "    topic_" << i << " [shape=ellipse, color=" << color << ", label=\""
+                   << escape(info.name) << "\\n" << escape(info.type) << "\\nmsg: " << info.msg_cnt
+                   << ", drop: " << info.drop_cnt << "\"];\n";
+                ss << "    pub_" << i << " [shape=box, label=\"" << info.pub_cnt << " publisher(s)\"];\n";
+                ss << "    sub_" << i << " [shape=box, label=\"" << info.sub_cnt << " subscriber(s)\\nfifo: [";
+                join(ss, info.fifo_sizes);
+                ss << "]\"];\n";
+                ss << "    pub_" << i << " -> topic_" << i << ";\n";
+                ss << "    topic_" << i << " -> sub_" << i << ";\n";
+                i++;
+            }
+            ss << "}\n";
+            return ss.str();
+        }
+
+        /**
+         * @brief 以JSON格式导出当前所有消息的运行时信息
+         * @return JSON格式字符串
+         */
+        static std::string dump_json() {
+            std::ostringstream ss;
+            ss << "[";
+            bool first = true;
+            for (const auto &info: topics()) {
+                if (!first) ss << ",";
+                first = false;
+                ss << "\n  {\"type\": \"" << escape(info.type) << "\", \"name\": \"" << escape(info.name)
+                   << "\", \"publishers\": " << info.pub_cnt << ", \"subscribers\": " << info.sub_cnt
+                   << ", \"messages\": " << info.msg_cnt << ", \"dropped\": " << info.drop_cnt
+                   << ", \"fifo_sizes\": [";
+                join(ss, info.fifo_sizes);
+                ss << "]}";
+            }
+            ss << "\n]\n";
+            return ss.str();
+        }
+
+    private:
+        using Getter = TopicInfo (*)(const std::shared_ptr<void> &);
+
+        /// 注册项，持有消息的弱引用，避免注册表延长消息的生命周期
+        struct Entry {
+            std::weak_ptr<void> p_pipe;
+            Getter getter;
+        };
+
+        static void add(const void *p, std::weak_ptr<void> p_pipe, Getter getter) {
+            std::unique_lock lock(_mtx);
+            _topics.emplace(p, Entry{std::move(p_pipe), getter});
+        }
+
+        static void remove(const void *p_pipe) {
+            std::unique_lock lock(_mtx);
+            _topics.erase(p_pipe);
+        }
+
+        /// 转义DOT和JSON字符串中的引号、反斜杠和控制字符
+        static std::string escape(const std::string &str) {
+            static constexpr char hex[] = "0123456789abcdef";
+            std::string result;
+            result.reserve(str.size());
+            for (char c: str) {
+                switch (c) {
+                    case '"':
+                    case '\\':
+                        result.push_back('\\');
+                        result.push_back(c);
+                        break;
+                    case '\n':
+                        result += "\\n";
+                        break;
+                    case '\r':
+                        result += "\\r";
+                        break;
+                    case '\t':
+                        result += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            result += "\\u00";
+                            result.push_back(hex[(c >> 4) & 0xf]);
+                            result.push_back(hex[c & 0xf]);
+                        } else {
+                            result.push_back(c);
+                        }
+                }
+            }
+            return result;
+        }
+
+        static void join(std::ostringstream &ss, const std::vector<size_t> &values) {
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i > 0) ss << ", ";
+                ss << values[i];
+            }
+        }
+
+        /// 注册表互斥锁
+        static std::mutex _mtx;
+        /// 所有存活的MessagePipe及其信息读取函数，以对象地址为键
+        static std::unordered_map<const void *, Entry> _topics;
+    };
+
+    inline std::mutex TopicRegistry::_mtx;
+
+    inline std::unordered_map<const void *, TopicRegistry::Entry> TopicRegistry::_topics;
+}
+
+#endif /* _UMT_REGISTRY_HPP_ */
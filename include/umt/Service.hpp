@@ -0,0 +1,268 @@
+#ifndef _UMT_SERVICE_HPP_
+#define _UMT_SERVICE_HPP_
+
+#include "ObjManager.hpp"
+#include "Message.hpp"
+#include <condition_variable>
+#include <functional>
+#include <stdexcept>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <queue>
+
+namespace umt {
+
+    template<class Req, class Resp>
+    class ServiceClient;
+
+    template<class Req, class Resp>
+    class ServiceServer;
+
+    /**
+     * @brief 请求/响应服务
+     * @details 记录了该服务上等待处理的请求，以及绑定到该服务上的server数量。
+     *          每个请求的响应只会通过future返回给发起该请求的client，不会广播。
+     * @tparam Req 请求对象类型
+     * @tparam Resp 响应对象类型
+     */
+    template<class Req, class Resp>
+    class Service {
+        friend class ServiceClient<Req, Resp>;
+
+        friend class ServiceServer<Req, Resp>;
+
+    public:
+        using ReqType = Req;
+        using RespType = Resp;
+    private:
+        /// 一次调用，包含请求对象和用于返回响应的promise
+        struct Call {
+            explicit Call(const Req &req) : req(req) {}
+
+            Req req;
+            std::promise<Resp> promise;
+            /// 调用方超时后置位，server会跳过已取消的请求
+            std::atomic<bool> cancelled{false};
+        };
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::queue<std::shared_ptr<Call>> calls;
+        size_t server_cnt{};
+    };
+
+    /**
+     * @brief 服务调用器类型
+     * @details 发起请求并通过std::future获取响应
+     * @tparam Req 请求对象类型
+     * @tparam Resp 响应对象类型
+     */
+    template<class Req, class Resp>
+    class ServiceClient {
+    private:
+        using SrvManager = ObjManager<Service<Req, Resp>>;
+        using Call = typename Service<Req, Resp>::Call;
+    public:
+        using ReqType = Req;
+        using RespType = Resp;
+
+        ServiceClient() = default;
+
+        /**
+         * @brief 调用器的构造函数
+         * @param srv_name 服务名称
+         */
+        explicit ServiceClient(const std::string &srv_name) {
+            bind(srv_name);
+        }
+
+        /// 重置调用器
+        void reset() {
+            p_srv.reset();
+        }
+
+        /**
+         * @brief 绑定当前调用器到某个名称的服务
+         * @param srv_name 服务名称
+         */
+        void bind(const std::string &srv_name) {
+            p_srv = SrvManager::find_or_create(srv_name);
+        }
+
+        /**
+         * @brief 发起一次请求
+         * @details 如果当前服务上没有server，则会抛出一条异常；
+         *          如果server在处理该请求前全部退出，future中会得到一条异常
+         * @param req 请求对象
+         * @return 用于获取响应的future
+         */
+        std::future<Resp> call(const Req &req) {
+            return submit(req)->promise.get_future();
+        }
+
+        /**
+         * @brief 发起一次请求并等待响应，有超时时间
+         * @details 如果当前服务上没有server，则会抛出一条异常；如果超时，也会抛出一条异常。
+         *          超时时仍在队列中的请求不会再被处理；已经开始处理的请求，处理函数仍会执行完毕，但其结果会被丢弃
+         * @param req 请求对象
+         * @param ms 超时时间，单位毫秒
+         * @return 响应对象
+         */
+        Resp call_for(const Req &req, size_t ms) {
+            return call_until(req, std::chrono::steady_clock::now() + std::chrono::milliseconds(ms));
+        }
+
+        /**
+         * @brief 发起一次请求并等待响应，直到某个时间点超时
+         * @details 如果当前服务上没有server，则会抛出一条异常；如果超时，也会抛出一条异常。
+         *          超时时仍在队列中的请求不会再被处理；已经开始处理的请求，处理函数仍会执行完毕，但其结果会被丢弃
+         * @param req 请求对象
+         * @param pt 超时时间点，为std::chrono::time_point类型
+         * @return 响应对象
+         */
+        template<class P>
+        Resp call_until(const Req &req, P pt) {
+            auto p_call = submit(req);
+            auto fut = p_call->promise.get_future();
+            if (fut.wait_until(pt) != std::future_status::ready) {
+                p_call->cancelled = true;
+                throw MessageError_Timeout();
+            }
+            return fut.get();
+        }
+
+    private:
+        std::shared_ptr<Call> submit(const Req &req) {
+            if (!p_srv) throw MessageError_Empty();
+            auto p_call = std::make_shared<Call>(req);
+            {
+                std::unique_lock lock(p_srv->mtx);
+                if (p_srv->server_cnt == 0) throw MessageError_Stopped();
+                p_srv->calls.emplace(p_call);
+            }
+            p_srv->cv.notify_one();
+            return p_call;
+        }
+
+    private:
+        typename SrvManager::sptr p_srv;
+    };
+
+    /**
+     * @brief 服务处理器类型
+     * @details 使用若干个工作线程处理请求，处理函数的返回值会直接返回给对应的调用方；
+     *          处理函数抛出的异常也会通过future传递给调用方。
+     *          同一个服务上可以绑定多个处理器，它们共同处理该服务的请求。
+     * @tparam Req 请求对象类型
+     * @tparam Resp 响应对象类型
+     */
+    template<class Req, class Resp>
+    class ServiceServer {
+    private:
+        using SrvManager = ObjManager<Service<Req, Resp>>;
+        using Call = typename Service<Req, Resp>::Call;
+    public:
+        using ReqType = Req;
+        using RespType = Resp;
+        using Handler = std::function<Resp(const Req &)>;
+
+        ServiceServer() = default;
+
+        /**
+         * @brief 处理器的构造函数
+         * @param srv_name 服务名称
+         * @param handler 请求处理函数，会在多个工作线程中同时调用，需要保证其线程安全性
+         * @param worker_num 工作线程数量，至少为1
+         */
+        ServiceServer(const std::string &srv_name, Handler handler, size_t worker_num = 1) {
+            bind(srv_name, std::move(handler), worker_num);
+        }
+
+        ServiceServer(const ServiceServer &) = delete;
+
+        ServiceServer &operator=(const ServiceServer &) = delete;
+
+        /// 析构函数
+        ~ServiceServer() { reset(); }
+
+        /**
+         * @brief 重置处理器
+         * @details 等待所有工作线程处理完当前请求后退出；如果这是该服务上的最后一个处理器，
+         *          队列中尚未处理的请求会收到一条MessageError_Stopped异常
+         */
+        void reset() {
+            if (!p_srv) return;
+            {
+                std::unique_lock lock(p_srv->mtx);
+                running = false;
+                if (--p_srv->server_cnt == 0) {
+                    while (!p_srv->calls.empty()) {
+                        auto p_call = std::move(p_srv->calls.front());
+                        p_srv->calls.pop();
+                        if (p_call->cancelled) continue;
+                        p_call->promise.set_exception(std::make_exception_ptr(MessageError_Stopped()));
+                    }
+                }
+            }
+            p_srv->cv.notify_all();
+            for (auto &worker: workers) worker.join();
+            workers.clear();
+            p_srv.reset();
+        }
+
+        /**
+         * @brief 绑定当前处理器到某个名称的服务，并启动工作线程
+         * @details 工作线程数量为0时抛出std::invalid_argument，当前绑定保持不变
+         * @param srv_name 服务名称
+         * @param handler 请求处理函数，会在多个工作线程中同时调用，需要保证其线程安全性
+         * @param worker_num 工作线程数量，至少为1
+         */
+        void bind(const std::string &srv_name, Handler handler, size_t worker_num = 1) {
+            if (worker_num == 0) throw std::invalid_argument("service worker number must be positive!");
+            reset();
+            p_srv = SrvManager::find_or_create(srv_name);
+            fn = std::move(handler);
+            {
+                std::unique_lock lock(p_srv->mtx);
+                running = true;
+                p_srv->server_cnt++;
+            }
+            for (size_t i = 0; i < worker_num; i++) {
+                workers.emplace_back([this]() { work(); });
+            }
+        }
+
+    private:
+        void work() {
+            while (true) {
+                std::shared_ptr<Call> p_call;
+                {
+                    std::unique_lock lock(p_srv->mtx);
+                    p_srv->cv.wait(lock, [this]() { return !running || !p_srv->calls.empty(); });
+                    if (!running) return;
+                    p_call = std::move(p_srv->calls.front());
+                    p_srv->calls.pop();
+                }
+                // 只能跳过尚未开始处理的请求，处理函数开始执行后调用方超时不会中断处理
+                if (p_call->cancelled) continue;
+                try {
+                    p_call->promise.set_value(fn(p_call->req));
+                } catch (...) {
+                    p_call->promise.set_exception(std::current_exception());
+                }
+            }
+        }
+
+    private:
+        /// 受p_srv->mtx保护
+        bool running{false};
+        Handler fn;
+        std::vector<std::thread> workers;
+        typename SrvManager::sptr p_srv;
+    };
+}
+
+#endif /* _UMT_SERVICE_HPP_ */
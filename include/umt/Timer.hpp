@@ -0,0 +1,380 @@
+#ifndef _UMT_TIMER_HPP_
+#define _UMT_TIMER_HPP_
+
+#ifdef __linux__
+
+#include "Message.hpp"
+#include "Sync.hpp"
+#include <condition_variable>
+#include <system_error>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace umt {
+
+    /**
+     * @brief 定时器统计信息
+     * @details 抖动为回调函数实际开始执行的时间与理论触发时间之差
+     */
+    struct TimerStats {
+        using Clock = std::chrono::steady_clock;
+
+        /// 回调函数执行次数
+        size_t fire_cnt{};
+        /// 由于上一次回调尚未结束或调度延迟而被跳过的触发次数
+        size_t overrun_cnt{};
+        /// 回调函数抛出异常的次数
+        size_t error_cnt{};
+        /// 最大抖动
+        Clock::duration max_jitter{};
+        /// 抖动总和
+        Clock::duration total_jitter{};
+
+        /// 平均抖动
+        Clock::duration mean_jitter() const {
+            return fire_cnt == 0 ? Clock::duration{} : total_jitter / static_cast<Clock::rep>(fire_cnt);
+        }
+    };
+
+    /**
+     * @brief 周期定时调度器
+     * @details 仅支持Linux。使用一个调度线程，通过timerfd以绝对时间等待最近的触发时间点，
+     *          到期后将回调函数分发到若干个工作线程中执行。
+     *          每个定时器的触发时间点按周期累加，不会随回调执行时间产生漂移；
+     *          同一个定时器的回调不会并发执行，上一次回调未结束时到期的触发会被跳过并计入overrun。
+     *          可配合ObjManager在多个模块间共享同一个调度器，如ObjManager<TimerScheduler>::find_or_create(name, 2)。
+     *          该对象下的所有函数满足线程安全性。
+     */
+    class TimerScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief 构造函数
+         * @param worker_num 执行回调函数的工作线程数量
+         */
+        explicit TimerScheduler(size_t worker_num = 1) {
+            tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (tfd < 0) throw std::system_error(errno, std::system_category(), "timerfd_create");
+            efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (efd < 0) {
+                ::close(tfd);
+                throw std::system_error(errno, std::system_category(), "eventfd");
+            }
+            dispatcher = std::thread([this]() { dispatch(); });
+            for (size_t i = 0; i < worker_num; i++) {
+                workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        TimerScheduler(const TimerScheduler &) = delete;
+
+        TimerScheduler &operator=(const TimerScheduler &) = delete;
+
+        /// 析构函数，等待正在执行的回调函数结束
+        ~TimerScheduler() {
+            {
+                std::unique_lock lock(mtx);
+                stop = true;
+            }
+            wakeup();
+            task_cv.notify_all();
+            dispatcher.join();
+            for (auto &worker: workers) worker.join();
+            ::close(tfd);
+            ::close(efd);
+        }
+
+        /**
+         * @brief 添加一个周期定时器
+         * @param period 触发周期
+         * @param fn 回调函数
+         * @param start 第一次触发的时间点，默认为当前时间加一个周期
+         * @return 定时器编号
+         */
+        size_t add(Clock::duration period, std::function<void()> fn, Clock::time_point start = {}) {
+            if (period <= Clock::duration::zero()) throw std::invalid_argument("timer period must be positive!");
+            auto p_timer = std::make_shared<Timer>();
+            p_timer->period = period;
+            p_timer->fn = std::move(fn);
+            if (start == Clock::time_point{}) start = Clock::now() + period;
+            size_t id;
+            {
+                std::unique_lock lock(mtx);
+                id = ++last_id;
+                timers.emplace(id, p_timer);
+                heap.emplace(Entry{start, p_timer});
+            }
+            wakeup();
+            return id;
+        }
+
+        /**
+         * @brief 添加一个周期发布消息的定时器
+         * @param period 触发周期
+         * @param pub 发布器，会拷贝一份到定时器中
+         * @param gen 生成待发布消息的函数
+         * @return 定时器编号
+         */
+        template<class T, class F>
+        size_t add_publish(Clock::duration period, const Publisher<T> &pub, F &&gen) {
+            return add(period, [p = pub, gen = std::forward<F>(gen)]() mutable { p.push(gen()); });
+        }
+
+        /**
+         * @brief 添加一个周期设置Sync值的定时器
+         * @param period 触发周期
+         * @param sync 同步器，会拷贝一份到定时器中
+         * @param gen 生成待设置值的函数
+         * @return 定时器编号
+         */
+        template<class T, class F>
+        size_t add_sync(Clock::duration period, const Sync<T> &sync, F &&gen) {
+            return add(period, [s = sync, gen = std::forward<F>(gen)]() mutable { s.set(gen()); });
+        }
+
+        /**
+         * @brief 删除一个定时器
+         * @details 回调函数没有在执行时，会立即释放回调函数及其捕获的对象（如Publisher、Sync的拷贝）；
+         *          正在执行的回调函数不会被打断，其捕获的对象在执行结束后释放。
+         *          如果需要等待正在执行的回调函数结束，请使用remove_and_wait()
+         * @param id 定时器编号
+         * @return 是否删除成功，编号不存在时返回false
+         */
+        bool remove(size_t id) {
+            std::function<void()> fn;
+            {
+                std::unique_lock lock(mtx);
+                auto p_timer = detach(id);
+                if (!p_timer) return false;
+                if (!p_timer->running) fn = std::move(p_timer->fn);
+            }
+            wakeup();
+            return true;
+        }
+
+        /**
+         * @brief 删除一个定时器，并等待其正在执行的回调函数结束
+         * @details 返回后回调函数不会再被调用，其捕获的对象也已经释放。不能在该定时器自己的回调函数中调用
+         * @param id 定时器编号
+         * @return 是否删除成功，编号不存在时返回false
+         */
+        bool remove_and_wait(size_t id) {
+            std::function<void()> fn;
+            {
+                std::unique_lock lock(mtx);
+                auto p_timer = detach(id);
+                if (!p_timer) return false;
+                done_cv.wait(lock, [&]() { return !p_timer->running; });
+                fn = std::move(p_timer->fn);
+            }
+            wakeup();
+            return true;
+        }
+
+        /**
+         * @brief 读取某个定时器的统计信息
+         * @param id 定时器编号
+         * @return 统计信息，编号不存在时返回空的统计信息
+         */
+        TimerStats stats(size_t id) const {
+            std::shared_ptr<Timer> p_timer;
+            {
+                std::unique_lock lock(mtx);
+                auto iter = timers.find(id);
+                if (iter == timers.end()) return {};
+                p_timer = iter->second;
+            }
+            std::unique_lock lock(p_timer->stats_mtx);
+            return p_timer->stats;
+        }
+
+    private:
+        struct Timer {
+            Clock::duration period{};
+            /// 回调函数，执行期间不会被修改；定时器删除后，在没有执行时由删除方或工作线程释放
+            std::function<void()> fn;
+            /// 受mtx保护
+            bool removed{false};
+            /// 回调函数是否正在执行或等待执行，受mtx保护
+            bool running{false};
+            std::mutex stats_mtx;
+            TimerStats stats;
+        };
+
+        struct Entry {
+            Clock::time_point deadline;
+            std::shared_ptr<Timer> p_timer;
+
+            bool operator>(const Entry &other) const { return deadline > other.deadline; }
+        };
+
+        /// 将定时器标记为删除并从编号表中移除，调用时需要持有mtx
+        std::shared_ptr<Timer> detach(size_t id) {
+            auto iter = timers.find(id);
+            if (iter == timers.end()) return nullptr;
+            auto p_timer = std::move(iter->second);
+            timers.erase(iter);
+            p_timer->removed = true;
+            purge = true;
+            return p_timer;
+        }
+
+        void wakeup() const {
+            uint64_t one = 1;
+            [[maybe_unused]] auto ret = ::write(efd, &one, sizeof(one));
+        }
+
+        /// 将timerfd设置为在某个绝对时间点触发，deadline为空时取消定时
+        void arm(Clock::time_point deadline) const {
+            itimerspec spec{};
+            if (deadline != Clock::time_point{}) {
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+                if (ns <= 0) ns = 1;
+                spec.it_value.tv_sec = ns / 1000000000;
+                spec.it_value.tv_nsec = ns % 1000000000;
+            }
+            timerfd_settime(tfd, TFD_TIMER_ABSTIME, &spec, nullptr);
+        }
+
+        void dispatch() {
+            std::unique_lock lock(mtx);
+            while (!stop) {
+                arm(heap.empty() ? Clock::time_point{} : heap.top().deadline);
+                lock.unlock();
+                pollfd fds[2] = {{tfd, POLLIN, 0},
+                                 {efd, POLLIN, 0}};
+                ::poll(fds, 2, -1);
+                uint64_t buf;
+                [[maybe_unused]] auto r0 = ::read(tfd, &buf, sizeof(buf));
+                [[maybe_unused]] auto r1 = ::read(efd, &buf, sizeof(buf));
+                lock.lock();
+
+                // 从堆中清除已删除的定时器
+                if (purge) {
+                    decltype(heap) kept;
+                    while (!heap.empty()) {
+                        if (!heap.top().p_timer->removed) kept.push(heap.top());
+                        heap.pop();
+                    }
+                    heap.swap(kept);
+                    purge = false;
+                }
+
+                auto now = Clock::now();
+                bool has_task = false;
+                while (!heap.empty() && heap.top().deadline <= now) {
+                    auto entry = heap.top();
+                    heap.pop();
+                    auto &timer = *entry.p_timer;
+                    if (timer.removed) continue;
+                    size_t overrun = 0;
+                    if (timer.running) {
+                        overrun++;
+                    } else {
+                        timer.running = true;
+                        tasks.emplace(entry);
+                        has_task = true;
+                    }
+                    // 按周期累加下一次触发时间点，跳过已经错过的周期
+                    auto next = entry.deadline + timer.period;
+                    if (next <= now) {
+                        auto missed = (now - next) / timer.period + 1;
+                        overrun += missed;
+                        next += missed * timer.period;
+                    }
+                    if (overrun > 0) {
+                        std::unique_lock stats_lock(timer.stats_mtx);
+                        timer.stats.overrun_cnt += overrun;
+                    }
+                    heap.emplace(Entry{next, std::move(entry.p_timer)});
+                }
+                if (has_task) task_cv.notify_all();
+            }
+        }
+
+        void work() {
+            while (true) {
+                Entry entry;
+                {
+                    std::unique_lock lock(mtx);
+                    task_cv.wait(lock, [this]() { return stop || !tasks.empty(); });
+                    if (stop) return;
+                    entry = std::move(tasks.front());
+                    tasks.pop();
+                }
+                auto &timer = *entry.p_timer;
+                if (!finish_if_removed(timer)) continue;
+                auto jitter = Clock::now() - entry.deadline;
+                bool error = false;
+                try {
+                    timer.fn();
+                } catch (...) {
+                    error = true;
+                }
+                {
+                    std::unique_lock stats_lock(timer.stats_mtx);
+                    timer.stats.fire_cnt++;
+                    timer.stats.error_cnt += error;
+                    timer.stats.total_jitter += jitter;
+                    if (jitter > timer.stats.max_jitter) timer.stats.max_jitter = jitter;
+                }
+                std::function<void()> fn;
+                {
+                    std::unique_lock lock(mtx);
+                    timer.running = false;
+                    if (timer.removed) fn = std::move(timer.fn);
+                }
+                done_cv.notify_all();
+            }
+        }
+
+        /**
+         * @brief 如果定时器在等待执行期间被删除，则不再执行，并释放其回调函数
+         * @return 是否需要执行回调函数
+         */
+        bool finish_if_removed(Timer &timer) {
+            std::function<void()> fn;
+            {
+                std::unique_lock lock(mtx);
+                if (!timer.removed) return true;
+                timer.running = false;
+                fn = std::move(timer.fn);
+            }
+            done_cv.notify_all();
+            return false;
+        }
+
+    private:
+        int tfd{-1};
+        int efd{-1};
+
+        mutable std::mutex mtx;
+        bool stop{false};
+        /// 是否有已删除的定时器需要从堆中清除
+        bool purge{false};
+        size_t last_id{};
+        std::unordered_map<size_t, std::shared_ptr<Timer>> timers;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+
+        std::condition_variable task_cv;
+        std::queue<Entry> tasks;
+        /// 回调函数执行结束时通知，用于remove_and_wait()
+        std::condition_variable done_cv;
+
+        std::thread dispatcher;
+        std::vector<std::thread> workers;
+    };
+}
+
+#endif /* __linux__ */
+
+#endif /* _UMT_TIMER_HPP_ */
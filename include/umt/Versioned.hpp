@@ -0,0 +1,167 @@
+#ifndef _UMT_VERSIONED_HPP_
+#define _UMT_VERSIONED_HPP_
+
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+namespace umt {
+
+    /**
+     * @brief 多版本（read-copy-update）共享对象
+     * @details 写者拷贝当前版本并修改，然后发布为新版本；旧版本在最后一个持有它的快照析构时自动释放。
+     *          read()在一个短互斥锁内拷贝当前版本的指针，不会等待写者执行修改函数；
+     *          高频读取的线程应使用Reader，在版本未变化时只读取一个原子版本号，完全无锁。
+     *          适用于读取频繁、修改很少的共享对象（如配置参数、标定参数），
+     *          可配合ObjManager使用，如ObjManager<Versioned<T>>::create(name, args...)。
+     * @tparam T 被管理的对象类型，需要可拷贝构造
+     */
+    template<class T>
+    class Versioned {
+    private:
+        struct Node {
+            template<class ...Ts>
+            explicit Node(size_t version, Ts &&...args): val(std::forward<Ts>(args)...), version(version) {}
+
+            const T val;
+            const size_t version;
+        };
+
+    public:
+        class Reader;
+
+        /**
+         * @brief 某个版本对象的只读快照
+         * @details 快照存在期间，对应版本的对象不会被释放，也不会被修改
+         */
+        class Snapshot {
+            friend class Versioned<T>;
+
+        public:
+            Snapshot() = default;
+
+            const T &operator*() const { return p_node->val; }
+
+            const T *operator->() const { return &p_node->val; }
+
+            /// 快照对应的版本号，每次发布新版本时加一
+            size_t version() const { return p_node->version; }
+
+            explicit operator bool() const { return static_cast<bool>(p_node); }
+
+        private:
+            explicit Snapshot(std::shared_ptr<const Node> p) : p_node(std::move(p)) {}
+
+            std::shared_ptr<const Node> p_node;
+        };
+
+        /**
+         * @brief 带缓存的读取器，每个读取线程持有一个
+         * @details 缓存最近一次读取的快照，版本号未变化时直接返回缓存，不加锁；
+         *          只有发布了新版本之后的第一次读取会通过read()刷新缓存。
+         *          读取器本身不满足线程安全性，不能在多个线程间共享。
+         */
+        class Reader {
+        public:
+            Reader() = default;
+
+            /**
+             * @brief 读取器的构造函数
+             * @param p_src 被读取的多版本对象
+             */
+            explicit Reader(std::shared_ptr<const Versioned> p_src) : p_src(std::move(p_src)) {}
+
+            /**
+             * @brief 获取当前版本的只读快照
+             * @return 当前版本的快照，在下一次调用read()之前有效
+             */
+            const Snapshot &read() {
+                if (!cache || p_src->cur_version.load(std::memory_order_acquire) != cache.version()) {
+                    cache = p_src->read();
+                }
+                return cache;
+            }
+
+        private:
+            std::shared_ptr<const Versioned> p_src;
+            Snapshot cache;
+        };
+
+        /**
+         * @brief 构造函数
+         * @param args 初始版本对象的构造函数参数
+         */
+        template<class ...Ts>
+        explicit Versioned(Ts &&...args): p_node(std::make_shared<const Node>(0, std::forward<Ts>(args)...)) {}
+
+        Versioned(const Versioned &) = delete;
+
+        Versioned &operator=(const Versioned &) = delete;
+
+        /**
+         * @brief 获取当前版本的只读快照
+         * @details 只在拷贝指针时持有一个短互斥锁，高频读取请使用Reader
+         * @return 当前版本的快照
+         */
+        Snapshot read() const {
+            std::unique_lock lock(node_mtx);
+            return Snapshot(p_node);
+        }
+
+        /**
+         * @brief 获取当前版本号，无锁
+         * @return 当前版本号
+         */
+        size_t version() const {
+            return cur_version.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief 发布一个新版本的对象
+         * @param val 新版本的对象
+         * @return 新版本的版本号
+         */
+        size_t write(T val) {
+            std::unique_lock lock(write_mtx);
+            return publish(std::move(val));
+        }
+
+        /**
+         * @brief 拷贝当前版本并修改，然后发布为新版本
+         * @details 多个写者之间互斥，读者不受影响
+         * @param fn 修改函数，参数为T&
+         * @return 新版本的版本号
+         */
+        template<class F>
+        size_t update(F &&fn) {
+            std::unique_lock lock(write_mtx);
+            T val = p_node->val;
+            fn(val);
+            return publish(std::move(val));
+        }
+
+    private:
+        /// 发布新版本，调用时需要持有write_mtx
+        size_t publish(T val) {
+            size_t version = p_node->version + 1;
+            auto p_new = std::make_shared<const Node>(version, std::move(val));
+            {
+                std::unique_lock lock(node_mtx);
+                p_node.swap(p_new);
+            }
+            cur_version.store(version, std::memory_order_release);
+            return version;
+        }
+
+        /// 写者互斥锁，写者执行修改函数期间持有，读者不会获取
+        std::mutex write_mtx;
+        /// 保护p_node的短互斥锁，只在拷贝或替换指针时持有
+        mutable std::mutex node_mtx;
+        /// 当前版本，读取需要持有node_mtx，替换需要同时持有write_mtx和node_mtx
+        std::shared_ptr<const Node> p_node;
+        /// 当前版本号，供Reader无锁判断缓存是否过期
+        std::atomic<size_t> cur_version{0};
+    };
+}
+
+#endif /* _UMT_VERSIONED_HPP_ */
@@ -5,8 +5,19 @@
 #ifndef _UMT_HPP_
 #define _UMT_HPP_
 
+#include "Memory.hpp"
 #include "ObjManager.hpp"
+#include "Registry.hpp"
 #include "Message.hpp"
 #include "Sync.hpp"
+#include "Service.hpp"
+
+#ifdef __linux__
+
+#include "Timer.hpp"
+
+#endif /* __linux__ */
+
+#include "Versioned.hpp"
 
 #endif /* _UMT_HPP_ */
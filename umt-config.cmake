@@ -12,3 +12,13 @@ else ()
     message("-- without boost.python")
 endif ()
 
+
+find_path(NUMA_INCLUDE_DIR numa.h)
+find_library(NUMA_LIBRARY numa)
+if (NUMA_INCLUDE_DIR AND NUMA_LIBRARY)
+    message("-- with libnuma")
+    list(APPEND umt_LIBS ${NUMA_LIBRARY})
+    add_compile_definitions(_UMT_WITH_NUMA_)
+else ()
+    message("-- without libnuma")
+endif ()